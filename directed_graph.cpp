@@ -1,4 +1,7 @@
 #include<directed_graph.h>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
 
 namespace Graph {
     //当使用依赖模板参数的类型时，必须使用typename关键字，
@@ -7,7 +10,7 @@ namespace Graph {
     typename directed_graph<T>::nodes_container_type::iterator
     directed_graph<T>::findNode(const T &node_value) {
         return std::find_if(std::begin(m_nodes), std::end(m_nodes),
-                            [&node_value](const auto &node) { return node.value == node_value; });
+                            [&node_value](const auto &node) { return node.value() == node_value; });
     }
 
     template<typename T>
@@ -33,7 +36,7 @@ namespace Graph {
         auto iter{findNode(node_value) };
         if(iter != std::end(m_nodes) )
             return std::pair{iterator {iter, this->shared_from_this() }, false};
-        m_nodes.emplace(this->shared_from_this(), std::move(node_value) );
+        m_nodes.emplace_back(std::move(node_value) );
         return {iterator{--std::end(m_nodes), this->shared_from_this() }, true};
 
     }
@@ -96,7 +99,7 @@ namespace Graph {
 //
 //        remove_all_links_to(iter);
 //        m_nodes.erase(iter);
-        if (pos == std::end(m_nodes))
+        if (pos.m_nodeIterator == std::end(m_nodes))
             return iterator{std::end(m_nodes), this->shared_from_this() };
 
         remove_all_links_to(pos.m_nodeIterator);
@@ -114,7 +117,7 @@ namespace Graph {
 //        return true;
         for(auto iter{first}; iter != last; iter++){
             if(iter.m_nodeIterator != std::end(m_nodes))
-                remove_all_links_to(iter.m_nodeIterator)
+                remove_all_links_to(iter.m_nodeIterator);
         }
         return iterator{m_nodes.erase(first.m_nodeIterator, last.m_nodeIterator), this->shared_from_this()};
     }
@@ -159,6 +162,121 @@ namespace Graph {
         m_nodes.swap(other_graph.m_nodes);
     }
 
+    template<typename T>
+    std::vector<typename directed_graph<T>::size_type>
+        directed_graph<T>::reorder(reorder_strategy strategy)
+    {
+        auto permutation{compute_ordering(strategy)};
+        reorder(permutation);
+        return permutation;
+    }
+
+    template<typename T>
+    void directed_graph<T>::reorder(const std::vector<size_type> &permutation)
+    {
+        const size_type count{m_nodes.size()};
+        if (permutation.size() != count)
+            throw std::invalid_argument{"reorder: permutation size does not match the graph size"};
+
+        //order[new_index] == old_index, count marks a slot nobody has claimed yet
+        std::vector<size_type> order(count, count);
+        for (size_type old_index{0}; old_index < count; ++old_index) {
+            const size_type new_index{permutation[old_index]};
+            if (new_index >= count || order[new_index] != count)
+                throw std::invalid_argument{"reorder: not a permutation of the node indices"};
+            order[new_index] = old_index;
+        }
+
+        //Everything that allocates happens before the first node is moved,
+        //so a std::bad_alloc leaves the graph untouched.
+        //The sets are built in new-index order with their indices sorted, so the tree nodes are also
+        //allocated in the order a traversal of the renumbered graph will visit them.
+        std::vector<typename details::graph_node<T>::adjacency_list_type> remapped(count);
+        std::vector<size_type> sorted;
+        for (size_type new_index{0}; new_index < count; ++new_index) {
+            const auto &adjacent{m_nodes[order[new_index]].get_adjacent_nodes_indices()};
+            sorted.clear();
+            for (auto index: adjacent) sorted.push_back(permutation[index]);
+            std::sort(std::begin(sorted), std::end(sorted));
+            auto &indices{remapped[new_index]};
+            for (auto index: sorted) indices.emplace_hint(std::end(indices), index);
+        }
+        nodes_container_type reordered;
+        reordered.reserve(count);
+
+        //按新顺序搬移节点：只有移动操作，不再分配内存
+        for (size_type new_index{0}; new_index < count; ++new_index) {
+            auto &node{m_nodes[order[new_index]]};
+            node.get_adjacent_nodes_indices() = std::move(remapped[new_index]);
+            reordered.push_back(std::move(node));
+        }
+        m_nodes.swap(reordered);
+    }
+
+    template<typename T>
+    std::vector<typename directed_graph<T>::size_type>
+        directed_graph<T>::compute_ordering(reorder_strategy strategy) const
+    {
+        const size_type count{m_nodes.size()};
+
+        //Symmetric view of the graph: an edge in either direction makes two nodes neighbours.
+        std::vector<std::vector<size_type> > neighbours(count);
+        for (size_type index{0}; index < count; ++index) {
+            for (auto adjacent: m_nodes[index].get_adjacent_nodes_indices()) {
+                if (adjacent == index) continue;
+                neighbours[index].push_back(adjacent);
+                neighbours[adjacent].push_back(index);
+            }
+        }
+        for (auto &&list: neighbours) {
+            std::sort(std::begin(list), std::end(list));
+            list.erase(std::unique(std::begin(list), std::end(list)), std::end(list));
+        }
+        const auto degree{[&neighbours](size_type index) { return neighbours[index].size(); }};
+
+        //order[new_index] == old_index
+        std::vector<size_type> order(count);
+        std::iota(std::begin(order), std::end(order), size_type{0});
+
+        if (strategy == reorder_strategy::degree_descending) {
+            std::stable_sort(std::begin(order), std::end(order),
+                             [&degree](size_type lhs, size_type rhs) { return degree(lhs) > degree(rhs); });
+        } else {
+            const bool by_degree{strategy != reorder_strategy::breadth_first};
+            //Cuthill-McKee starts every component at its lowest-degree node
+            std::vector<size_type> starts(order);
+            if (by_degree) {
+                std::stable_sort(std::begin(starts), std::end(starts),
+                                 [&degree](size_type lhs, size_type rhs) { return degree(lhs) < degree(rhs); });
+                for (auto &&list: neighbours)
+                    std::stable_sort(std::begin(list), std::end(list),
+                                     [&degree](size_type lhs, size_type rhs) { return degree(lhs) < degree(rhs); });
+            }
+
+            //order doubles as the BFS queue: everything past head is still waiting to be expanded
+            std::vector<bool> visited(count, false);
+            size_type tail{0};
+            for (auto start: starts) {
+                if (visited[start]) continue;
+                visited[start] = true;
+                order[tail++] = start;
+                for (size_type head{tail - 1}; head < tail; ++head) {
+                    for (auto adjacent: neighbours[order[head]]) {
+                        if (visited[adjacent]) continue;
+                        visited[adjacent] = true;
+                        order[tail++] = adjacent;
+                    }
+                }
+            }
+            if (strategy == reorder_strategy::reverse_cuthill_mckee)
+                std::reverse(std::begin(order), std::end(order));
+        }
+
+        std::vector<size_type> permutation(count);
+        for (size_type new_index{0}; new_index < count; ++new_index) permutation[order[new_index]] = new_index;
+        return permutation;
+    }
+
     template<typename T>
     T &directed_graph<T>::operator[](size_type index) {
         return m_nodes[index].value();
@@ -187,7 +305,7 @@ namespace Graph {
         if (m_nodes.size() != rhs.m_nodes.size()) return false;
         //2.check each node
         for (auto &&node: m_nodes) {
-            const auto rhsNodeIter{rhs.findNode(node)};
+            const auto rhsNodeIter{rhs.findNode(node.value())};
             if (rhsNodeIter == std::end(rhs.m_nodes)) return false;
 
             const auto adjacent_values_lhs{get_adjacent_nodes_values(node.get_adjacent_nodes_indices())};
@@ -202,7 +320,7 @@ namespace Graph {
             const typename details::graph_node<T>::adjacency_list_type &indices) const {
         std::set<T> values;
         //'auto&&' universal references, it can bind to both lvalues and rvalues.
-        for (auto &&index: indices) values.insert(index);
+        for (auto &&index: indices) values.insert(m_nodes[index].value());
 
         return values;
     }
@@ -278,10 +396,10 @@ namespace Graph {
         return end();
     }
 
-
-
-
-
-
-
-}
\ No newline at end of file
+    //The member definitions live in this file rather than in the header,
+    //so only the value types instantiated here can be linked against.
+    template class directed_graph<int>;
+    template class directed_graph<long>;
+    template class directed_graph<long long>;
+    template class directed_graph<double>;
+}
@@ -1,3 +1,4 @@
+#pragma once
 //const at end of the declaretion
 // a constant member function. It means that within this function, 
 //you cannot modify any member variables of the object (except those explicitly marked as mutable).
@@ -6,6 +7,18 @@
 
 namespace Graph
 {
+       // Node orderings understood by directed_graph::reorder(). Edges are treated as undirected
+       // when computing an ordering, so both in- and out-neighbours are placed close together.
+       enum class reorder_strategy {
+           breadth_first,          // BFS from each unvisited node in current index order
+           cuthill_mckee,          // BFS from the lowest-degree node, neighbours by ascending degree
+           reverse_cuthill_mckee,  // Cuthill-McKee order reversed, usually the smaller bandwidth
+           degree_descending       // hubs first, ties keep their current relative order
+       };
+
+       template <typename T>
+       class directed_graph_builder;
+
        template <typename T>
        class directed_graph : public std::enable_shared_from_this<directed_graph<T>> {
            public:
@@ -49,6 +62,15 @@ namespace Graph
 
            void swap(directed_graph& other_graph) noexcept;
 
+           // Renumber the nodes so that neighbours sit close together in m_nodes.
+           // Returns the permutation that was applied: permutation[old_index] == new_index.
+           // Both overloads replace m_nodes, so every outstanding iterator is invalidated and
+           // indices stored by the caller must be mapped through the permutation.
+           std::vector<size_type> reorder(reorder_strategy strategy);
+           // Apply a caller supplied permutation (permutation[old_index] == new_index).
+           // Throws std::invalid_argument if it is not a permutation of [0, size()).
+           void reorder(const std::vector<size_type>& permutation);
+
            [[nodiscard]] size_type size() const noexcept;
            [[nodiscard]] size_type max_size() const noexcept;
            [[nodiscard]] bool empty() const noexcept;
@@ -73,6 +95,7 @@ namespace Graph
            // This means that any instance of class B can access the private and protected data members and member functions of any instance of class A.
            friend class directed_graph_iterator<directed_graph>;
            friend class const_directed_graph_iterator<directed_graph>;
+           friend class directed_graph_builder<T>;
 
            using nodes_container_type = std::vector<details::graph_node<T> >;
            nodes_container_type m_nodes;
@@ -82,6 +105,8 @@ namespace Graph
 
            void remove_all_links_to(typename nodes_container_type::const_iterator node_iter);
 
+           [[nodiscard]] std::vector<size_type> compute_ordering(reorder_strategy strategy) const;
+
            [[nodiscard]]size_t get_index_of_node(const typename directed_graph<T>::nodes_container_type::const_iterator& iter) const noexcept;
        };
 
@@ -0,0 +1,75 @@
+#include<directed_graph_builder.h>
+#include <algorithm>
+
+namespace Graph
+{
+    template<typename T>
+    directed_graph_builder<T>::directed_graph_builder(std::shared_ptr<directed_graph<T> > graph)
+            : m_graph{std::move(graph)}
+    {
+        m_indices.reserve(m_graph->m_nodes.size());
+        for (size_type index{0}; index < m_graph->m_nodes.size(); ++index)
+            m_indices.emplace(m_graph->m_nodes[index].value(), index);
+    }
+
+    template<typename T>
+    typename directed_graph_builder<T>::size_type
+        directed_graph_builder<T>::add_node(const T& node_value)
+    {
+        //try_emplace只在值第一次出现时插入，已存在时返回原有下标
+        const auto [iter, inserted]{m_indices.try_emplace(node_value, m_graph->m_nodes.size())};
+        if (inserted)
+            m_graph->m_nodes.emplace_back(node_value);
+        return iter->second;
+    }
+
+    template<typename T>
+    void directed_graph_builder<T>::add_edge(const T& from_node_value, const T& to_node_value)
+    {
+        const size_type from_index{add_node(from_node_value)};
+        const size_type to_index{add_node(to_node_value)};
+        m_graph->m_nodes[from_index].get_adjacent_nodes_indices().insert(to_index);
+    }
+
+    template<typename T>
+    void directed_graph_builder<T>::add_nodes(std::span<const T> node_values)
+    {
+        for (auto&& node_value: node_values) add_node(node_value);
+    }
+
+    template<typename T>
+    void directed_graph_builder<T>::add_edges(std::span<const edge_type> edges)
+    {
+        //先按文件顺序解析下标（节点编号保持首次出现的顺序），再排序后插入：
+        //同一节点的邻接集合连续写入，且每次都插在末尾附近，缓存命中率高得多
+        m_pending.clear();
+        m_pending.reserve(edges.size());
+        for (auto&& [from, to]: edges) {
+            const size_type from_index{add_node(from)};
+            m_pending.emplace_back(from_index, add_node(to));
+        }
+        std::sort(std::begin(m_pending), std::end(m_pending));
+        for (auto&& [from_index, to_index]: m_pending) {
+            auto& indices{m_graph->m_nodes[from_index].get_adjacent_nodes_indices()};
+            indices.emplace_hint(std::end(indices), to_index);
+        }
+    }
+
+    template<typename T>
+    void directed_graph_builder<T>::reserve(size_type node_count)
+    {
+        m_graph->m_nodes.reserve(node_count);
+        m_indices.reserve(node_count);
+    }
+
+    template<typename T>
+    std::shared_ptr<directed_graph<T> > directed_graph_builder<T>::graph() const noexcept
+    {
+        return m_graph;
+    }
+
+    template class directed_graph_builder<int>;
+    template class directed_graph_builder<long>;
+    template class directed_graph_builder<long long>;
+    template class directed_graph_builder<double>;
+}
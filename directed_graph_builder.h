@@ -0,0 +1,47 @@
+#pragma once
+// Bulk construction of a directed_graph.
+// insert()/insert_edge() look every value up with a linear findNode(), which makes loading n edges O(n * V).
+// The builder keeps its own value -> index hash map and writes straight into m_nodes, so each edge costs O(log degree).
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "directed_graph.h"
+
+namespace Graph
+{
+    // Instantiated for int, long, long long and double, the value types directed_graph is instantiated for.
+    template<typename T>
+    class directed_graph_builder {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using edge_type = std::pair<T, T>;
+
+        // Nodes already present in graph are indexed up front, so the builder can extend an existing graph.
+        // That index is a snapshot: calling insert(), erase(), clear(), swap() or reorder() on the graph
+        // while the builder is still in use leaves it pointing at the wrong nodes.
+        explicit directed_graph_builder(std::shared_ptr<directed_graph<T> > graph);
+
+        // Returns the index of node_value in the graph, appending it if it is not there yet.
+        size_type add_node(const T& node_value);
+        void add_edge(const T& from_node_value, const T& to_node_value);
+
+        // Batch versions, used by the edge list loader to hand over one parsed chunk at a time.
+        // add_edges() sorts the batch by node index before touching the adjacency sets, which is
+        // several times faster than add_edge() in a loop once the graph no longer fits in cache.
+        void add_nodes(std::span<const T> node_values);
+        void add_edges(std::span<const edge_type> edges);
+
+        void reserve(size_type node_count);
+
+        [[nodiscard]] std::shared_ptr<directed_graph<T> > graph() const noexcept;
+
+    private:
+        std::shared_ptr<directed_graph<T> > m_graph;
+        std::unordered_map<T, size_type> m_indices;
+        std::vector<std::pair<size_type, size_type> > m_pending; // add_edges() scratch, kept to reuse its capacity
+    };
+}
@@ -0,0 +1,461 @@
+#include<directed_graph_from_edge_list.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Graph
+{
+namespace details
+{
+    edge_list_source::edge_list_source(const std::filesystem::path& path, size_t block_size)
+            : m_block_size{std::max<size_t>(block_size, 1)}
+    {
+#if !defined(_WIN32)
+        //文件映射到内存后由内核按需调页，省去一次从内核缓冲区到用户缓冲区的拷贝
+        //只有普通文件才在这里打开：管道或FIFO只能打开一次（交给下面的流），否则写端会看到第一个读端关闭
+        std::error_code error;
+        if (std::filesystem::is_regular_file(path, error)) {
+            const int fd{::open(path.c_str(), O_RDONLY)};
+            if (fd < 0)
+                throw std::runtime_error{"edge list: cannot open " + path.string()};
+            struct stat info{};
+            if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+                void* mapping{::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+                if (mapping != MAP_FAILED) {
+                    ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                    m_mapping = static_cast<const char*>(mapping);
+                    m_mapping_size = static_cast<size_t>(info.st_size);
+                }
+            }
+            ::close(fd); // the mapping keeps its own reference to the file
+            if (m_mapping) return;
+        }
+#endif
+        m_stream.open(path, std::ios::binary);
+        if (!m_stream)
+            throw std::runtime_error{"edge list: cannot open " + path.string()};
+    }
+
+    edge_list_source::~edge_list_source()
+    {
+#if !defined(_WIN32)
+        if (m_mapping)
+            ::munmap(const_cast<char*>(m_mapping), m_mapping_size);
+#endif
+    }
+
+    std::string_view edge_list_source::next_block()
+    {
+        return m_mapping ? next_mapped_block() : next_read_block();
+    }
+
+    size_t edge_list_source::block_offset() const noexcept
+    {
+        return m_block_offset;
+    }
+
+    std::string_view edge_list_source::next_mapped_block()
+    {
+        m_block_offset = m_position;
+        if (m_position == m_mapping_size) return {};
+
+        size_t end{std::min(m_position + m_block_size, m_mapping_size)};
+        if (end != m_mapping_size) {
+            // Extend the block to the end of the line it stops in.
+            const auto* newline{static_cast<const char*>(std::memchr(m_mapping + end, '\n', m_mapping_size - end))};
+            end = newline ? static_cast<size_t>(newline - m_mapping) + 1 : m_mapping_size;
+        }
+        const std::string_view block{m_mapping + m_position, end - m_position};
+        m_position = end;
+        return block;
+    }
+
+    std::string_view edge_list_source::next_read_block()
+    {
+        // The unfinished last line of the previous block moves to the front of the buffer.
+        std::copy(std::begin(m_buffer) + static_cast<std::ptrdiff_t>(m_consumed),
+                  std::begin(m_buffer) + static_cast<std::ptrdiff_t>(m_filled), std::begin(m_buffer));
+        m_block_offset += m_consumed;
+        m_filled -= m_consumed;
+        m_consumed = 0;
+
+        // A line longer than m_block_size makes the buffer grow until the line fits.
+        while (m_stream) {
+            if (m_buffer.size() < m_filled + m_block_size) m_buffer.resize(m_filled + m_block_size);
+            const size_t search_from{m_filled};
+            m_stream.read(m_buffer.data() + m_filled, static_cast<std::streamsize>(m_block_size));
+            m_filled += static_cast<size_t>(m_stream.gcount());
+            if (m_stream.bad())
+                throw std::runtime_error{"edge list: read error"};
+
+            const auto first{std::begin(m_buffer) + static_cast<std::ptrdiff_t>(search_from)};
+            const auto last{std::begin(m_buffer) + static_cast<std::ptrdiff_t>(m_filled)};
+            const auto newline{std::find(std::make_reverse_iterator(last), std::make_reverse_iterator(first), '\n')};
+            if (m_stream && newline.base() != first) {
+                m_consumed = static_cast<size_t>(newline.base() - std::begin(m_buffer));
+                return {m_buffer.data(), m_consumed};
+            }
+        }
+        // End of file: whatever is left is the last block, with or without a trailing newline.
+        m_consumed = m_filled;
+        return {m_buffer.data(), m_filled};
+    }
+
+    worker_pool::worker_pool(size_t thread_count)
+    {
+        m_workers.reserve(thread_count);
+        for (size_t index{0}; index < thread_count; ++index)
+            m_workers.emplace_back([this, index](std::stop_token stop) { work(stop, index); });
+    }
+
+    void worker_pool::start(std::function<void(size_t)> task)
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_task = std::move(task);
+            m_pending = m_workers.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+    }
+
+    void worker_pool::wait()
+    {
+        std::unique_lock lock{m_mutex};
+        m_done.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    void worker_pool::work(std::stop_token stop, size_t index)
+    {
+        size_t generation{0};
+        while (true) {
+            {
+                //jthread析构时request_stop()会唤醒这里的等待，线程随即退出
+                std::unique_lock lock{m_mutex};
+                if (!m_wake.wait(lock, stop, [&] { return m_generation != generation; })) return;
+                generation = m_generation;
+            }
+            m_task(index);
+
+            std::lock_guard lock{m_mutex};
+            if (--m_pending == 0) m_done.notify_all();
+        }
+    }
+
+    std::vector<std::string_view> split_lines(std::string_view block, size_t parts)
+    {
+        std::vector<std::string_view> pieces;
+        // Rounded up: every piece but the last holds at least target bytes, so there are never more than parts.
+        parts = std::max<size_t>(parts, 1);
+        const size_t target{std::max<size_t>((block.size() + parts - 1) / parts, 1)};
+        size_t begin{0};
+        while (begin < block.size()) {
+            size_t end{std::min(begin + target, block.size())};
+            end = block.find('\n', end - 1);
+            end = end == std::string_view::npos ? block.size() : end + 1;
+            pieces.push_back(block.substr(begin, end - begin));
+            begin = end;
+        }
+        return pieces;
+    }
+
+    enum class edge_list_line { blank, node, edge, malformed };
+
+    inline bool is_blank(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* skip_blanks(const char* first, const char* last) noexcept
+    {
+        while (first != last && is_blank(*first)) ++first;
+        return first;
+    }
+
+    // Parse one value, optionally quoted as DOT ids may be. Returns nullptr if there is no number at first.
+    template<typename T>
+    const char* parse_edge_list_value(const char* first, const char* last, T& value)
+    {
+        const bool quoted{first != last && *first == '"'};
+        if (quoted) ++first;
+        const auto [ptr, ec]{std::from_chars(first, last, value)};
+        if (ec != std::errc{}) return nullptr;
+        if (!quoted) return ptr;
+        return ptr != last && *ptr == '"' ? ptr + 1 : nullptr;
+    }
+
+    // True if a value may end at first: end of line, a blank, or the separator the format uses.
+    inline bool at_value_end(const char* first, const char* last, edge_list_format format) noexcept
+    {
+        return first == last || is_blank(*first) || (format == edge_list_format::csv && *first == ',');
+    }
+
+    template<typename T>
+    edge_list_line parse_edge_list_line(const char* first, const char* last, edge_list_format format,
+                                        T& from, T& to)
+    {
+        first = skip_blanks(first, last);
+        if (first == last || *first == '#' || *first == '%') return edge_list_line::blank;
+
+        const char* next{parse_edge_list_value(first, last, from)};
+        if (!next || !at_value_end(next, last, format)) return edge_list_line::malformed;
+        next = skip_blanks(next, last);
+
+        switch (format) {
+            case edge_list_format::csv:
+                if (next == last) return edge_list_line::node;
+                if (*next != ',') return edge_list_line::malformed;
+                ++next;
+                break;
+            default:
+                if (next == last) return edge_list_line::node;
+                break;
+        }
+
+        next = parse_edge_list_value(skip_blanks(next, last), last, to);
+        // Anything after the second value, such as a weight column, is ignored.
+        if (!next || !at_value_end(next, last, format)) return edge_list_line::malformed;
+        return edge_list_line::edge;
+    }
+
+    inline bool is_dot_word_char(char c) noexcept
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    // Skip a DOT id (a word, a number or a quoted string). Returns nullptr if there is none at first.
+    inline const char* skip_dot_id(const char* first, const char* last) noexcept
+    {
+        if (first != last && *first == '"') {
+            const auto* close{static_cast<const char*>(std::memchr(first + 1, '"', static_cast<size_t>(last - first - 1)))};
+            return close ? close + 1 : nullptr;
+        }
+        const char* end{first};
+        while (end != last && (is_dot_word_char(*end) || *end == '.' || *end == '-')) ++end;
+        return end == first ? nullptr : end;
+    }
+
+    // Skip a "[...]" attribute list, quoted values may contain ']'. Returns nullptr if it does not close on this line.
+    inline const char* skip_dot_attributes(const char* first, const char* last) noexcept
+    {
+        bool quoted{false};
+        for (++first; first != last; ++first) {
+            if (*first == '"') quoted = !quoted;
+            else if (*first == ']' && !quoted) return first + 1;
+        }
+        return nullptr;
+    }
+
+    // Parse every statement on one DOT line. Node statements ("4;") and edge statements, chains included
+    // ("1 -> 2 -> 3 [label=x];"), go to result. Graph headers, braces, attribute statements and // comments
+    // are skipped. Returns false for anything else, including node ids that are not numbers.
+    template<typename T>
+    bool parse_dot_line(const char* first, const char* last, parsed_chunk<T>& result)
+    {
+        while (true) {
+            first = skip_blanks(first, last);
+            if (first == last) return true;
+            const char c{*first};
+            if (c == ';' || c == '{' || c == '}') {
+                ++first;
+                continue;
+            }
+            if (c == '#' || (c == '/' && last - first > 1 && first[1] == '/')) return true;
+
+            if (c == '"' || c == '-' || c == '.' || (c >= '0' && c <= '9')) {
+                T from{};
+                first = parse_edge_list_value(first, last, from);
+                if (!first) return false;
+                bool edge_statement{false};
+                for (first = skip_blanks(first, last); last - first >= 2 && first[0] == '-' && first[1] == '>';
+                     first = skip_blanks(first, last)) {
+                    T to{};
+                    first = parse_edge_list_value(skip_blanks(first + 2, last), last, to);
+                    if (!first) return false;
+                    result.edges.emplace_back(from, to);
+                    from = to;
+                    edge_statement = true;
+                }
+                if (!edge_statement) result.nodes.emplace_back(result.edges.size(), from);
+            } else if (is_dot_word_char(c)) {
+                const char* word_end{first};
+                while (word_end != last && is_dot_word_char(*word_end)) ++word_end;
+                const std::string_view word{first, static_cast<size_t>(word_end - first)};
+                first = skip_blanks(word_end, last);
+                if (first != last && *first == '=') {
+                    // graph attribute such as rankdir=LR
+                    first = skip_dot_id(skip_blanks(first + 1, last), last);
+                    if (!first) return false;
+                } else if ((word == "node" || word == "edge" || word == "graph") && first != last && *first == '[') {
+                    // default attributes, handled with the trailing attribute list below
+                } else if (word == "strict" || word == "digraph" || word == "graph" || word == "subgraph") {
+                    // header: everything up to the opening brace is the graph name
+                    const auto* brace{static_cast<const char*>(std::memchr(first, '{', static_cast<size_t>(last - first)))};
+                    if (!brace) return true;
+                    first = brace + 1;
+                    continue;
+                } else {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+
+            first = skip_blanks(first, last);
+            if (first != last && *first == '[') {
+                first = skip_dot_attributes(first, last);
+                if (!first) return false;
+                first = skip_blanks(first, last);
+            }
+            if (first != last && *first != ';' && *first != '}') return false;
+        }
+    }
+
+    template<typename T>
+    void parse_edge_list_chunk(std::string_view chunk, size_t chunk_offset, edge_list_format format,
+                               parsed_chunk<T>& result)
+    {
+        const char* const chunk_begin{chunk.data()};
+        const char* const chunk_end{chunk.data() + chunk.size()};
+        for (const char* line{chunk_begin}; line != chunk_end;) {
+            const char* line_end{static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(chunk_end - line)))};
+            if (!line_end) line_end = chunk_end;
+
+            const auto malformed{[&] {
+                const size_t line_offset{chunk_offset + static_cast<size_t>(line - chunk_begin)};
+                return std::runtime_error{"edge list: malformed line at byte offset " + std::to_string(line_offset)};
+            }};
+
+            T from{}, to{};
+            if (format == edge_list_format::dot) {
+                if (!parse_dot_line(line, line_end, result)) throw malformed();
+            } else switch (parse_edge_list_line(line, line_end, format, from, to)) {
+                case edge_list_line::edge:
+                    result.edges.emplace_back(from, to);
+                    break;
+                case edge_list_line::node:
+                    result.nodes.emplace_back(result.edges.size(), from);
+                    break;
+                case edge_list_line::blank:
+                    break;
+                case edge_list_line::malformed:
+                    // The first line of a CSV file may be a header such as "source,target".
+                    if (format == edge_list_format::csv && chunk_offset == 0 && line == chunk_begin) break;
+                    throw malformed();
+            }
+            line = line_end == chunk_end ? chunk_end : line_end + 1;
+        }
+    }
+}
+
+namespace details
+{
+    // One block of the file on its way through the parser threads.
+    template<typename T>
+    struct parsed_block {
+        size_t offset{0};
+        std::vector<std::string_view> chunks;
+        std::vector<parsed_chunk<T> > results;
+        std::vector<std::exception_ptr> errors;
+    };
+}
+
+    template<typename T>
+    void load_edge_list(const std::filesystem::path& path, directed_graph_builder<T>& builder,
+                        const edge_list_options& options)
+    {
+        static_assert(std::is_arithmetic_v<T>, "edge list values are parsed with std::from_chars");
+
+        const size_t thread_count{std::max<size_t>(options.thread_count, 1)};
+        details::edge_list_source source{path, options.block_size};
+        // Two blocks in flight: the pool parses one while this thread hands the other to the builder.
+        std::array<details::parsed_block<T>, 2> blocks;
+        for (auto&& block: blocks) {
+            block.results.resize(thread_count);
+            block.errors.resize(thread_count);
+        }
+        // Declared after source and blocks, so its threads are joined before what they parse goes away.
+        details::worker_pool pool{thread_count};
+
+        const auto start_parsing{[&](details::parsed_block<T>& parsed) {
+            const auto text{source.next_block()};
+            parsed.offset = source.block_offset();
+            parsed.chunks = details::split_lines(text, thread_count);
+            if (parsed.chunks.empty()) return false;
+            pool.start([&parsed, text, format{options.format}](size_t index) {
+                if (index >= parsed.chunks.size()) return;
+                try {
+                    const auto& chunk{parsed.chunks[index]};
+                    const size_t chunk_offset{parsed.offset + static_cast<size_t>(chunk.data() - text.data())};
+                    details::parse_edge_list_chunk(chunk, chunk_offset, format, parsed.results[index]);
+                } catch (...) {
+                    parsed.errors[index] = std::current_exception();
+                }
+            });
+            return true;
+        }};
+
+        size_t current{0};
+        for (bool parsing{start_parsing(blocks[current])}; parsing; current ^= 1) {
+            pool.wait();
+            auto& parsed{blocks[current]};
+            for (auto&& error: parsed.errors)
+                if (error) std::rethrow_exception(error);
+
+            // The parsed values no longer point into the block text, so the source may move on to the next block.
+            parsing = start_parsing(blocks[current ^ 1]);
+
+            for (size_t index{0}; index < parsed.chunks.size(); ++index) {
+                // Chunks are handed over in file order and lone nodes are slotted back between the edges
+                // they were read between, so node indices follow first appearance in the file.
+                auto&& [edges, nodes]{parsed.results[index]};
+                auto edge_iter{std::cbegin(edges)};
+                for (auto&& [edges_before, node_value]: nodes) {
+                    const auto node_position{std::cbegin(edges) + static_cast<std::ptrdiff_t>(edges_before)};
+                    builder.add_edges({edge_iter, node_position});
+                    builder.add_node(node_value);
+                    edge_iter = node_position;
+                }
+                builder.add_edges({edge_iter, std::cend(edges)});
+                nodes.clear();
+                edges.clear();
+            }
+        }
+    }
+
+    template<typename T>
+    std::shared_ptr<directed_graph<T> > directed_graph_from_edge_list(const std::filesystem::path& path,
+                                                                      const edge_list_options& options)
+    {
+        directed_graph_builder<T> builder{std::make_shared<directed_graph<T> >()};
+        load_edge_list(path, builder, options);
+        return builder.graph();
+    }
+
+    //Definitions stay in this file like the rest of the library; these are the value types that link.
+    template void load_edge_list<int>(const std::filesystem::path&, directed_graph_builder<int>&, const edge_list_options&);
+    template std::shared_ptr<directed_graph<int> > directed_graph_from_edge_list<int>(const std::filesystem::path&, const edge_list_options&);
+    template void details::parse_edge_list_chunk<int>(std::string_view, size_t, edge_list_format, details::parsed_chunk<int>&);
+    template void load_edge_list<long>(const std::filesystem::path&, directed_graph_builder<long>&, const edge_list_options&);
+    template std::shared_ptr<directed_graph<long> > directed_graph_from_edge_list<long>(const std::filesystem::path&, const edge_list_options&);
+    template void details::parse_edge_list_chunk<long>(std::string_view, size_t, edge_list_format, details::parsed_chunk<long>&);
+    template void load_edge_list<long long>(const std::filesystem::path&, directed_graph_builder<long long>&, const edge_list_options&);
+    template std::shared_ptr<directed_graph<long long> > directed_graph_from_edge_list<long long>(const std::filesystem::path&, const edge_list_options&);
+    template void details::parse_edge_list_chunk<long long>(std::string_view, size_t, edge_list_format, details::parsed_chunk<long long>&);
+    template void load_edge_list<double>(const std::filesystem::path&, directed_graph_builder<double>&, const edge_list_options&);
+    template std::shared_ptr<directed_graph<double> > directed_graph_from_edge_list<double>(const std::filesystem::path&, const edge_list_options&);
+    template void details::parse_edge_list_chunk<double>(std::string_view, size_t, edge_list_format, details::parsed_chunk<double>&);
+}
@@ -0,0 +1,121 @@
+#pragma once
+// Loading a directed_graph from an edge list file, one edge ("from to") or lone node ("node") per line.
+// The file is memory mapped where the platform allows it (large block reads otherwise) and handed out in blocks of whole lines.
+// Every block is split at line boundaries and the pieces are parsed in parallel with std::from_chars on a fixed pool of
+// threads. While the pool parses the next block, the calling thread feeds the previous one to a directed_graph_builder
+// in file order, so node indices follow first appearance.
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "directed_graph_builder.h"
+
+namespace Graph
+{
+    enum class edge_list_format {
+        whitespace, // "1 2", blanks or tabs between the values, '#' or '%' starts a comment line
+        csv,        // "1,2", a non-numeric first line is taken to be a header
+        dot         // node ("1;") and edge ("1 -> 2 -> 3;") statements of a digraph, ids must be numbers;
+                    // headers, braces, attribute statements and // comments are skipped
+    };
+
+    struct edge_list_options {
+        edge_list_format format{edge_list_format::whitespace};
+        unsigned thread_count{std::thread::hardware_concurrency()};
+        size_t block_size{size_t{64} << 20}; // bytes handed to the parser threads at a time
+    };
+
+    // Append every node and edge in the file to builder. Throws std::runtime_error if the file
+    // cannot be read or a line is malformed; the message carries the byte offset of the line.
+    // No rollback: blocks before the failing one have already been added to the builder's graph,
+    // so a graph being extended is left partly loaded. Load into a fresh graph and swap() it in
+    // if the original must survive a bad file.
+    // Instantiated for int, long, long long and double.
+    template<typename T>
+    void load_edge_list(const std::filesystem::path& path, directed_graph_builder<T>& builder,
+                        const edge_list_options& options = {});
+
+    template<typename T>
+    std::shared_ptr<directed_graph<T> > directed_graph_from_edge_list(const std::filesystem::path& path,
+                                                                      const edge_list_options& options = {});
+
+namespace details
+{
+    // Hands out a file as consecutive blocks of whole lines.
+    class edge_list_source {
+    public:
+        edge_list_source(const std::filesystem::path& path, size_t block_size);
+        ~edge_list_source();
+
+        edge_list_source(const edge_list_source&) = delete;
+        edge_list_source& operator=(const edge_list_source&) = delete;
+
+        // Valid until the next call; an empty view means the whole file has been returned.
+        std::string_view next_block();
+        // File offset of the first byte of the block last returned by next_block().
+        [[nodiscard]] size_t block_offset() const noexcept;
+
+    private:
+        size_t m_block_size;
+        size_t m_block_offset{0};
+
+        // memory mapped input
+        const char* m_mapping{nullptr};
+        size_t m_mapping_size{0};
+        size_t m_position{0};
+
+        // block read fallback, used when the file cannot be mapped
+        std::ifstream m_stream;
+        std::vector<char> m_buffer;
+        size_t m_filled{0};
+        size_t m_consumed{0};
+
+        std::string_view next_mapped_block();
+        std::string_view next_read_block();
+    };
+
+    // A fixed set of threads that all run the same task, one call per thread, each time start() is called.
+    class worker_pool {
+    public:
+        explicit worker_pool(size_t thread_count);
+
+        // Calls task(thread_index) once on every thread. The task must not throw, and the
+        // previous task must have finished (see wait()) before the next one is started.
+        void start(std::function<void(size_t)> task);
+        void wait();
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable_any m_wake;
+        std::condition_variable m_done;
+        std::function<void(size_t)> m_task;
+        size_t m_generation{0};
+        size_t m_pending{0};
+        std::vector<std::jthread> m_workers; // last, so the threads are joined before the state they use goes away
+
+        void work(std::stop_token stop, size_t index);
+    };
+
+    // Cut block into at most parts pieces of roughly equal size, each ending at a line boundary.
+    [[nodiscard]] std::vector<std::string_view> split_lines(std::string_view block, size_t parts);
+
+    template<typename T>
+    struct parsed_chunk {
+        std::vector<std::pair<T, T> > edges;
+        // Lines that name a single node, each paired with the number of edges parsed before it.
+        std::vector<std::pair<size_t, T> > nodes;
+    };
+
+    // chunk_offset is the file offset of chunk.front(), used for error messages and CSV header detection.
+    template<typename T>
+    void parse_edge_list_chunk(std::string_view chunk, size_t chunk_offset, edge_list_format format,
+                               parsed_chunk<T>& result);
+}
+}
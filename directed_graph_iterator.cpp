@@ -1,4 +1,4 @@
-#include "directed_graph_iterator.h"
+#include "directed_graph.h"
 namespace Graph
 {
 
@@ -130,5 +130,12 @@ namespace Graph
         return  oldIter;
     }
 
-
-}
\ No newline at end of file
+    template class const_directed_graph_iterator<directed_graph<int> >;
+    template class const_directed_graph_iterator<directed_graph<long> >;
+    template class const_directed_graph_iterator<directed_graph<long long> >;
+    template class const_directed_graph_iterator<directed_graph<double> >;
+    template class directed_graph_iterator<directed_graph<int> >;
+    template class directed_graph_iterator<directed_graph<long> >;
+    template class directed_graph_iterator<directed_graph<long long> >;
+    template class directed_graph_iterator<directed_graph<double> >;
+}
@@ -10,12 +10,12 @@ template<typename T> class directed_graph;
 namespace details
 {
        template<typename T>
-       graph_node<T>::graph_node(std::shared_ptr<directed_graph<T> > graph, const T& t)
-       : m_graph(std::move(graph)), m_data(t){}
+       graph_node<T>::graph_node(const T& t)
+       : m_data(t){}
 
        template<typename T> 
-       graph_node<T>::graph_node(std::shared_ptr<directed_graph<T> > graph, T&& t)
-       : m_graph(std::move(graph)), m_data(std::move(t)){}
+       graph_node<T>::graph_node(T&& t)
+       : m_data(std::move(t)){}
 
        template<typename T> 
        T& graph_node<T>::value() noexcept {return m_data;}
@@ -36,6 +36,11 @@ namespace details
               {
                      return m_adjacencyNodeIndices;
               }
+
+       template class graph_node<int>;
+       template class graph_node<long>;
+       template class graph_node<long long>;
+       template class graph_node<double>;
 }
 }
 
@@ -1,3 +1,4 @@
+#pragma once
 // .cppm files are primarily used to define module interface units
 // A module interface unit declares the public-facing parts of a module that can be imported by other translation units.
 // export module declarations, export statements for functions, classes, and other entities that are intended to be accessible outside the module.
@@ -10,13 +11,16 @@
 namespace Graph
 {
 template<typename T> class directed_graph;
+template<typename T> class directed_graph_builder;
 
 namespace details
 {
        template<typename T> class graph_node{
        public:
-              graph_node(std::shared_ptr<directed_graph<T> > graph, const T& t);
-              graph_node(std::shared_ptr<directed_graph<T> > graph, T&& t);
+              // A node does not point back at its graph: the graph owns the nodes through a
+              // shared_ptr, so a shared_ptr back-pointer kept every graph alive forever.
+              explicit graph_node(const T& t);
+              explicit graph_node(T&& t);
 
               [[nodiscard]] T& value() noexcept;
               [[nodiscard]] const T& value() const noexcept;
@@ -25,8 +29,8 @@ namespace details
 
        private:
               friend class directed_graph<T>;
+              friend class directed_graph_builder<T>;
 
-              std::shared_ptr<directed_graph<T> > m_graph;
               T m_data;
 
               using adjacency_list_type = std::set<size_t>;
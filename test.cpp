@@ -1,6 +1,271 @@
 #include "directed_graph.h"
+#include "directed_graph_from_edge_list.h"
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    int failures{0};
+
+    void check(bool condition, const char* what)
+    {
+        if (condition) return;
+        std::cerr << "FAILED: " << what << '\n';
+        ++failures;
+    }
+
+    std::shared_ptr<Graph::directed_graph<int> > make_sample_graph()
+    {
+        auto graph = std::make_shared<Graph::directed_graph<int> >();
+        for (int value: {10, 20, 30, 40, 50, 60}) graph->insert(value);
+        graph->insert_edge(10, 50);
+        graph->insert_edge(50, 20);
+        graph->insert_edge(20, 60);
+        graph->insert_edge(60, 10);
+        graph->insert_edge(60, 60);
+        graph->insert_edge(40, 30);
+        return graph;
+    }
+
+    std::map<int, std::set<int> > adjacency_of(const Graph::directed_graph<int>& graph)
+    {
+        std::map<int, std::set<int> > adjacency;
+        for (size_t index{0}; index < graph.size(); ++index)
+            adjacency[graph[index]] = graph.get_adjacent_nodes_values(graph[index]);
+        return adjacency;
+    }
+
+    void test_reorder()
+    {
+        using Graph::reorder_strategy;
+        for (auto strategy: {reorder_strategy::breadth_first, reorder_strategy::cuthill_mckee,
+                             reorder_strategy::reverse_cuthill_mckee, reorder_strategy::degree_descending}) {
+            auto graph{make_sample_graph()};
+            std::vector<int> values_before;
+            for (size_t index{0}; index < graph->size(); ++index) values_before.push_back((*graph)[index]);
+            const auto adjacency_before{adjacency_of(*graph)};
+
+            const auto permutation{graph->reorder(strategy)};
+            check(permutation.size() == values_before.size(), "reorder: permutation covers every node");
+            for (size_t old_index{0}; old_index < values_before.size(); ++old_index)
+                check((*graph)[permutation[old_index]] == values_before[old_index], "reorder: node moved to permutation[old]");
+            check(adjacency_of(*graph) == adjacency_before, "reorder: edges survive the renumbering");
+
+            // Applying the inverse permutation restores the original numbering.
+            std::vector<size_t> inverse(permutation.size());
+            for (size_t old_index{0}; old_index < permutation.size(); ++old_index) inverse[permutation[old_index]] = old_index;
+            graph->reorder(inverse);
+            for (size_t index{0}; index < values_before.size(); ++index)
+                check((*graph)[index] == values_before[index], "reorder: inverse permutation round-trips");
+            check(adjacency_of(*graph) == adjacency_before, "reorder: edges survive the round-trip");
+        }
+
+        // The path 5-3-1-4-2 plus the isolated node 6, edges pointing either way.
+        const auto make_path_graph{[] {
+            auto graph = std::make_shared<Graph::directed_graph<int> >();
+            for (int value{1}; value <= 6; ++value) graph->insert(value);
+            graph->insert_edge(5, 3);
+            graph->insert_edge(1, 3);
+            graph->insert_edge(1, 4);
+            graph->insert_edge(2, 4);
+            return graph;
+        }};
+        const std::vector<std::pair<reorder_strategy, std::vector<int> > > expected_orders{
+                {reorder_strategy::breadth_first, {1, 3, 4, 5, 2, 6}},
+                {reorder_strategy::cuthill_mckee, {6, 2, 4, 1, 3, 5}},
+                {reorder_strategy::reverse_cuthill_mckee, {5, 3, 1, 4, 2, 6}},
+                {reorder_strategy::degree_descending, {1, 3, 4, 2, 5, 6}}};
+        for (auto&& [strategy, expected]: expected_orders) {
+            auto graph{make_path_graph()};
+            graph->reorder(strategy);
+            std::vector<int> values;
+            for (size_t index{0}; index < graph->size(); ++index) values.push_back((*graph)[index]);
+            check(values == expected, "reorder: expected node order for the path graph");
+        }
+
+        // Hubs first: 10, 20, 50 and 60 have two neighbours each, 30 and 40 only one.
+        auto graph{make_sample_graph()};
+        graph->reorder(reorder_strategy::degree_descending);
+        check((*graph)[0] == 10 && (*graph)[4] == 30 && (*graph)[5] == 40, "reorder: degree_descending keeps ties stable");
+
+        const auto adjacency_before{adjacency_of(*graph)};
+        const auto expect_invalid{[&graph](const std::vector<size_t>& permutation, const char* what) {
+            bool thrown{false};
+            try { graph->reorder(permutation); }
+            catch (const std::invalid_argument&) { thrown = true; }
+            check(thrown, what);
+        }};
+        expect_invalid({0, 1, 2}, "reorder: wrong size throws");
+        expect_invalid({0, 1, 2, 3, 4, 4}, "reorder: duplicate index throws");
+        expect_invalid({0, 1, 2, 3, 4, 6}, "reorder: out of range index throws");
+        check(adjacency_of(*graph) == adjacency_before, "reorder: a rejected permutation leaves the graph alone");
+
+        auto empty = std::make_shared<Graph::directed_graph<int> >();
+        check(empty->reorder(reorder_strategy::reverse_cuthill_mckee).empty(), "reorder: empty graph");
+    }
+
+    // A directory of its own under the system temp directory, so concurrent runs do not
+    // overwrite each other's inputs. It is removed with everything in it on destruction.
+    class scratch_directory {
+    public:
+        scratch_directory()
+        {
+            std::random_device random;
+            do m_path = std::filesystem::temp_directory_path() / ("graph_tests_" + std::to_string(random()));
+            while (!std::filesystem::create_directory(m_path));
+        }
+        ~scratch_directory()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(m_path, error);
+        }
+        scratch_directory(const scratch_directory&) = delete;
+        scratch_directory& operator=(const scratch_directory&) = delete;
+
+        [[nodiscard]] const std::filesystem::path& path() const noexcept { return m_path; }
+
+        std::filesystem::path write(const char* name, const std::string& contents) const
+        {
+            const auto path{m_path / name};
+            std::ofstream{path, std::ios::binary} << contents;
+            return path;
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    std::vector<int> values_of(const Graph::directed_graph<int>& graph)
+    {
+        std::vector<int> values;
+        for (size_t index{0}; index < graph.size(); ++index) values.push_back(graph[index]);
+        return values;
+    }
+
+    bool throws_runtime_error(const std::filesystem::path& path, const Graph::edge_list_options& options)
+    {
+        try { Graph::directed_graph_from_edge_list<int>(path, options); }
+        catch (const std::runtime_error&) { return true; }
+        return false;
+    }
+
+    void test_edge_list()
+    {
+        using Graph::edge_list_format;
+        const scratch_directory scratch;
+        const std::map<int, std::set<int> > expected{{1, {2}}, {2, {3}}, {3, {1}}, {4, {}}, {5, {5}}};
+
+        const auto whitespace{scratch.write("graph_whitespace.txt", "# comment\n1 2\n2\t3 0.5\n\n4\n3 1\r\n5 5")};
+        for (size_t block_size: {size_t{1}, size_t{7}, size_t{1} << 20}) {
+            for (unsigned thread_count: {1u, 3u}) {
+                const auto graph{Graph::directed_graph_from_edge_list<int>(
+                        whitespace, {edge_list_format::whitespace, thread_count, block_size})};
+                check(adjacency_of(*graph) == expected, "edge list: whitespace edges");
+                check(values_of(*graph) == std::vector<int>{1, 2, 3, 4, 5}, "edge list: nodes numbered in file order");
+            }
+        }
+
+        const auto csv{scratch.write("graph.csv", "source,target\n1,2\n 2 , 3\n3,1\n4\n5,5\n")};
+        check(adjacency_of(*Graph::directed_graph_from_edge_list<int>(csv, {edge_list_format::csv, 2, 8})) == expected,
+              "edge list: csv with a header");
+
+        const auto dot{scratch.write("graph.dot", "digraph G {\n\"1\" -> \"2\";\n2 -> 3 [label=x];\n3 -> 1;\n4;\n5 -> 5;\n}\n")};
+        check(adjacency_of(*Graph::directed_graph_from_edge_list<int>(dot, {edge_list_format::dot, 2, 16})) == expected,
+              "edge list: dot");
+
+        // Five one-byte lines over four threads used to come back as five pieces.
+        check(Graph::details::split_lines("1\n2\n3\n4\n5\n", 4).size() <= 4, "edge list: split_lines respects parts");
+        const auto lines{scratch.write("graph_lines.txt", "1\n2\n3\n4\n5\n")};
+        for (unsigned thread_count{1}; thread_count <= 8; ++thread_count) {
+            check(Graph::directed_graph_from_edge_list<int>(lines, {edge_list_format::whitespace, thread_count})->size() == 5,
+                  "edge list: more lines than threads");
+            for (size_t length{0}; length <= 40; ++length) {
+                const std::string block(length, '\n');
+                check(Graph::details::split_lines(block, thread_count).size() <= thread_count,
+                      "edge list: split_lines never returns more than parts pieces");
+            }
+        }
+
+        // Edge chains, several statements on one line, attribute statements and quoted ']' inside attributes.
+        const auto dot_statements{scratch.write("graph_statements.dot",
+                "strict digraph \"G\" { rankdir=LR; node [shape=box];\n"
+                "1 -> 2 -> 3 [label=\"a]b\"];\n6 -> 7; 7 -> 8;\n4 ; 9 }\n")};
+        const auto statements{Graph::directed_graph_from_edge_list<int>(dot_statements, {edge_list_format::dot, 2})};
+        check(adjacency_of(*statements) == std::map<int, std::set<int> >{
+                      {1, {2}}, {2, {3}}, {3, {}}, {4, {}}, {6, {7}}, {7, {8}}, {8, {}}, {9, {}}},
+              "edge list: dot chains and multiple statements per line");
+        check(throws_runtime_error(scratch.write("graph_names.dot", "digraph {\na -> b;\n}\n"), {edge_list_format::dot}),
+              "edge list: dot ids that are not numbers throw");
+        check(throws_runtime_error(scratch.write("graph_trailing.dot", "digraph {\n1 -> 2 x;\n}\n"), {edge_list_format::dot}),
+              "edge list: dot text after a statement throws");
+        check(throws_runtime_error(scratch.write("graph_open.dot", "1 -> 2 [label=x\n"), {edge_list_format::dot}),
+              "edge list: dot attribute list left open throws");
+
+        check(throws_runtime_error(scratch.write("graph_malformed.txt", "1 2\n3 x\n"), {}), "edge list: malformed line throws");
+        std::string long_file;
+        for (int line{0}; line < 2000; ++line) long_file += std::to_string(line) + ' ' + std::to_string(line + 1) + '\n';
+        const auto long_path{scratch.write("graph_long.txt", long_file)};
+        const auto long_graph{Graph::directed_graph_from_edge_list<int>(long_path, {edge_list_format::whitespace, 3, 256})};
+        check(long_graph->size() == 2001 && long_graph->get_adjacent_nodes_values(1999) == std::set<int>{2000},
+              "edge list: many blocks through the worker pool");
+        check(throws_runtime_error(scratch.write("graph_late_error.txt", long_file + "x\n" + long_file),
+                                   {edge_list_format::whitespace, 3, 256}),
+              "edge list: malformed line in a later block throws");
+        check(throws_runtime_error(scratch.write("graph_header.txt", "source target\n1 2\n"), {}),
+              "edge list: only csv skips a header");
+        check(throws_runtime_error(scratch.path() / "graph_missing.txt", {}),
+              "edge list: missing file throws");
+
+#if !defined(_WIN32)
+        // A FIFO cannot be memory mapped, so these loads go through the block-read fallback.
+        const auto fifo{scratch.path() / "graph.fifo"};
+        check(::mkfifo(fifo.c_str(), 0600) == 0, "edge list: mkfifo");
+        const auto load_through_fifo{[&fifo](const std::string& contents, size_t block_size) {
+            std::jthread writer{[&fifo, &contents] { std::ofstream{fifo, std::ios::binary} << contents; }};
+            return Graph::directed_graph_from_edge_list<int>(fifo, {edge_list_format::whitespace, 3, block_size});
+        }};
+        const std::string small_file{"# comment\n1 2\n2\t3 0.5\n\n4\n3 1\r\n5 5"};
+        for (size_t block_size: {size_t{1}, size_t{7}, size_t{1000}, size_t{100000}}) {
+            const auto small{load_through_fifo(small_file, block_size)};
+            check(adjacency_of(*small) == expected && values_of(*small) == std::vector<int>{1, 2, 3, 4, 5},
+                  "edge list: fifo, last line without a newline");
+            check(adjacency_of(*load_through_fifo(long_file, block_size)) == adjacency_of(*long_graph),
+                  "edge list: fifo, many blocks");
+        }
+#endif
+
+        // Nodes do not own their graph, so dropping the last handle frees a loaded graph.
+        std::weak_ptr<Graph::directed_graph<int> > dropped{Graph::directed_graph_from_edge_list<int>(long_path)};
+        check(dropped.expired(), "edge list: a loaded graph is destroyed with its last handle");
+        std::weak_ptr<Graph::directed_graph<int> > dropped_sample{make_sample_graph()};
+        check(dropped_sample.expired(), "graph: a graph built with insert() is destroyed with its last handle");
+
+        // The builder extends a graph that already has nodes, reusing their indices.
+        auto graph{make_sample_graph()};
+        Graph::directed_graph_builder<int> builder{graph};
+        Graph::load_edge_list(scratch.write("graph_extend.txt", "30 10\n70 40\n"), builder);
+        check(graph->size() == 7 && graph->get_adjacent_nodes_values(30) == std::set<int>{10}
+              && graph->get_adjacent_nodes_values(70) == std::set<int>{40}, "edge list: load into an existing graph");
+    }
+}
 
 int main()
 {
-    auto graph = std::make_shared<Graph::directed_graph<int> >();
-}
\ No newline at end of file
+    test_reorder();
+    test_edge_list();
+
+    if (failures != 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "all checks passed\n";
+    return 0;
+}